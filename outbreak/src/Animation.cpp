@@ -0,0 +1,160 @@
+#include "Animation.h"
+
+#define ANIM_MAX_DURATION ((1u << (ANIM_WHEEL_BITS * ANIM_WHEEL_LEVELS)) - 1)
+
+void animClearHandle(void *ctx, int, const float *) {
+    *(AnimHandle *)ctx = 0;
+}
+
+Animator::Animator() {
+    for (int l = 0; l < ANIM_WHEEL_LEVELS; ++l)
+        for (int s = 0; s < ANIM_WHEEL_SLOTS; ++s)
+            wheel[l][s] = -1;
+    pool.reserve(1024);
+}
+
+int Animator::alloc() {
+    int idx;
+    if (!freeList.empty()) {
+        idx = freeList.back();
+        freeList.pop_back();
+    } else {
+        idx = (int)pool.size();
+        pool.push_back(Anim());
+        pool[idx].gen = 0;
+    }
+    Anim &a = pool[idx];
+    a.inUse = true;
+    a.next = a.prev = -1;
+    a.level = a.slot = -1;
+    liveCount++;
+    return idx;
+}
+
+void Animator::release(int idx) {
+    Anim &a = pool[idx];
+    a.inUse = false;
+    a.gen++; // invalidates outstanding handles
+    freeList.push_back(idx);
+    liveCount--;
+}
+
+AnimHandle Animator::handleOf(int idx) const {
+    return ((AnimHandle)pool[idx].gen << 32) | (Uint32)(idx + 1);
+}
+
+int Animator::indexOf(AnimHandle h) const {
+    int idx = (int)(Uint32)h - 1;
+    if (idx < 0 || idx >= (int)pool.size() || !pool[idx].inUse) return -1;
+    if (handleOf(idx) != h) return -1;
+    return idx;
+}
+
+// Level is picked by how far away the expiry is, slot by the expiry time itself
+void Animator::schedule(int idx) {
+    Anim &a = pool[idx];
+    Sint32 delta = (Sint32)(a.end - now);
+    if (delta < 0) delta = 0;
+    int level = 0;
+    while (level < ANIM_WHEEL_LEVELS - 1 && (Uint32)delta >= (1u << (ANIM_WHEEL_BITS * (level + 1))))
+        level++;
+    int slot = (a.end >> (ANIM_WHEEL_BITS * level)) & (ANIM_WHEEL_SLOTS - 1);
+    a.level = level;
+    a.slot = slot;
+    a.prev = -1;
+    a.next = wheel[level][slot];
+    if (a.next != -1) pool[a.next].prev = idx;
+    wheel[level][slot] = idx;
+}
+
+void Animator::unlink(int idx) {
+    Anim &a = pool[idx];
+    if (a.level < 0) return;
+    if (a.prev != -1) pool[a.prev].next = a.next;
+    else wheel[a.level][a.slot] = a.next;
+    if (a.next != -1) pool[a.next].prev = a.prev;
+    a.next = a.prev = -1;
+    a.level = a.slot = -1;
+}
+
+// Moves everything in the current slot of a higher level down towards level 0
+void Animator::cascade(int level) {
+    int slot = (now >> (ANIM_WHEEL_BITS * level)) & (ANIM_WHEEL_SLOTS - 1);
+    int i = wheel[level][slot];
+    wheel[level][slot] = -1;
+    while (i != -1) {
+        int next = pool[i].next;
+        schedule(i);
+        i = next;
+    }
+}
+
+void Animator::advance(Uint32 to) {
+    while ((Sint32)(to - now) > 0) {
+        if (liveCount == 0) { now = to; break; } // nothing to expire, skip ahead
+        now++;
+        int idx = now & (ANIM_WHEEL_SLOTS - 1);
+        for (int level = 1; level < ANIM_WHEEL_LEVELS; ++level) {
+            if ((now >> (ANIM_WHEEL_BITS * level - ANIM_WHEEL_BITS)) & (ANIM_WHEEL_SLOTS - 1)) break;
+            cascade(level);
+        }
+        // New expiries are at least 1ms out so never land in this slot while it drains
+        while (wheel[0][idx] != -1) {
+            int i = wheel[0][idx];
+            unlink(i);
+            Anim &a = pool[i];
+            AnimDoneFn done = a.done;
+            void *ctx = a.ctx;
+            int arg = a.arg;
+            float value[4] = { a.to[0], a.to[1], a.to[2], a.to[3] };
+            release(i); // before the callback so it may start a follow-up on the same target
+            if (done) done(ctx, arg, value);
+        }
+    }
+}
+
+AnimHandle Animator::tween(Uint32 duration, const float from[4], const float to[4],
+                           AnimDoneFn done, void *ctx, int arg) {
+    if (duration < 1) duration = 1;
+    if (duration > ANIM_MAX_DURATION) duration = ANIM_MAX_DURATION;
+    int idx = alloc();
+    Anim &a = pool[idx];
+    a.start = now;
+    a.end = now + duration;
+    for (int c = 0; c < 4; ++c) {
+        a.from[c] = from ? from[c] : 0;
+        a.to[c] = to ? to[c] : 0;
+    }
+    a.done = done;
+    a.ctx = ctx;
+    a.arg = arg;
+    schedule(idx);
+    return handleOf(idx);
+}
+
+AnimHandle Animator::timer(Uint32 duration, AnimDoneFn done, void *ctx, int arg) {
+    return tween(duration, NULL, NULL, done, ctx, arg);
+}
+
+void Animator::cancel(AnimHandle h) {
+    int idx = indexOf(h);
+    if (idx < 0) return;
+    unlink(idx);
+    release(idx);
+}
+
+bool Animator::active(AnimHandle h) const {
+    return indexOf(h) >= 0;
+}
+
+bool Animator::sample(AnimHandle h, float out[4]) const {
+    int idx = indexOf(h);
+    if (idx < 0) return false;
+    const Anim &a = pool[idx];
+    float t = (float)(now - a.start) / (float)(a.end - a.start);
+    if (t > 1) t = 1;
+    t = t * t * (3 - 2 * t); // smoothstep
+    for (int c = 0; c < 4; ++c)
+        out[c] = a.from[c] + (a.to[c] - a.from[c]) * t;
+    return true;
+}
@@ -0,0 +1,72 @@
+#ifndef __ANIMATION_H
+#define __ANIMATION_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+// Hierarchical timer wheel: 4 levels of 64 slots at 1ms resolution
+#define ANIM_WHEEL_BITS 6
+#define ANIM_WHEEL_SLOTS (1 << ANIM_WHEEL_BITS)
+#define ANIM_WHEEL_LEVELS 4
+
+typedef Uint64 AnimHandle; // pool index + 1 in the low half, generation in the high; 0 = none
+// Called once when an animation runs to completion (not when cancelled)
+typedef void (*AnimDoneFn)(void *ctx, int arg, const float *value);
+
+// AnimDoneFn that zeroes the AnimHandle ctx points at
+void animClearHandle(void *ctx, int arg, const float *value);
+
+/*
+  Tweens and timers for game effects, driven by the game clock in ms.
+
+  A tween is just a start/end time and four from/to channels: it is
+  sampled when drawn, so frames cost nothing for animations in flight.
+  Only completion goes through the wheel, which makes start, cancel and
+  expiry O(1) and advance() proportional to what is actually due.
+  Records are pooled and handles carry the slot's full 32-bit generation,
+  so a stale handle reads as inactive until that one slot is reused 2^32
+  times.
+*/
+struct Animator {
+    Animator();
+
+    // Runs every expiry up to the game clock time now
+    void advance(Uint32 now);
+    AnimHandle tween(Uint32 duration, const float from[4], const float to[4],
+                     AnimDoneFn done = NULL, void *ctx = NULL, int arg = 0);
+    AnimHandle timer(Uint32 duration, AnimDoneFn done = NULL, void *ctx = NULL, int arg = 0);
+    void cancel(AnimHandle h);
+    bool active(AnimHandle h) const;
+    // Eased channel values at the current time; false if h is not active
+    bool sample(AnimHandle h, float out[4]) const;
+    int live() const { return liveCount; }
+
+private:
+    struct Anim {
+        Uint32 start, end;
+        float from[4], to[4];
+        AnimDoneFn done;
+        void *ctx;
+        int arg;
+        Uint32 gen;
+        bool inUse;
+        int next, prev; // links within a wheel slot
+        int level, slot;
+    };
+
+    int alloc();
+    void release(int idx);
+    void schedule(int idx);
+    void unlink(int idx);
+    void cascade(int level);
+    int indexOf(AnimHandle h) const;
+    AnimHandle handleOf(int idx) const;
+
+    std::vector<Anim> pool;
+    std::vector<int> freeList;
+    int wheel[ANIM_WHEEL_LEVELS][ANIM_WHEEL_SLOTS];
+    Uint32 now = 0;
+    int liveCount = 0;
+};
+
+#endif // __ANIMATION_H
@@ -0,0 +1,102 @@
+#include "BrickShape.h"
+#include <algorithm>
+#include <cmath>
+
+static BrickShapeSample shapeTables[BRICK_SHAPE_COUNT][BRICK_SDF_H][BRICK_SDF_W];
+static float shapeOutlines[BRICK_SHAPE_COUNT][BRICK_OUTLINE_POINTS][2];
+static bool shapeTablesReady = false;
+
+// Rounded box distance, (px,py) relative to the brick centre; r=0 is a plain rect
+static float roundedBoxDistance(float px, float py, float r) {
+    float qx = fabsf(px) - BRICK_XSIZE/2.0f + r;
+    float qy = fabsf(py) - BRICK_YSIZE/2.0f + r;
+    float ox = std::max(qx, 0.0f), oy = std::max(qy, 0.0f);
+    return sqrtf(ox*ox + oy*oy) + std::min(std::max(qx, qy), 0.0f) - r;
+}
+
+// No closed form for ellipses, so walk the outline; only runs at startup
+static float ellipseDistance(float px, float py) {
+    const int STEPS = 1024;
+    float a = BRICK_XSIZE/2.0f, b = BRICK_YSIZE/2.0f;
+    float best = 1e9f;
+    for (int k = 0; k < STEPS; ++k) {
+        float t = k * (2.0f * (float)M_PI / STEPS);
+        float dx = px - a * cosf(t);
+        float dy = py - b * sinf(t);
+        best = std::min(best, dx*dx + dy*dy);
+    }
+    bool inside = (px*px)/(a*a) + (py*py)/(b*b) <= 1.0f;
+    return inside ? -sqrtf(best) : sqrtf(best);
+}
+
+static float shapeDistance(int shape, float px, float py) {
+    switch (shape) {
+        case BRICK_SHAPE_ELLIPSE: return ellipseDistance(px, py);
+        case BRICK_SHAPE_ROUNDED: return roundedBoxDistance(px, py, BRICK_CORNER_RADIUS);
+        default:                  return roundedBoxDistance(px, py, 0);
+    }
+}
+
+// Distance from the centre to the outline along (dx,dy), a unit vector
+static float outlineRadius(int shape, float dx, float dy) {
+    float a = BRICK_XSIZE/2.0f, b = BRICK_YSIZE/2.0f;
+    float adx = fabsf(dx), ady = fabsf(dy);
+    if (shape == BRICK_SHAPE_ELLIPSE)
+        return a*b / sqrtf(b*b*adx*adx + a*a*ady*ady);
+    float t = std::min(adx > 1e-6f ? a/adx : 1e9f, ady > 1e-6f ? b/ady : 1e9f);
+    if (shape != BRICK_SHAPE_ROUNDED) return t;
+    // Ray leaves through a corner: intersect with the corner circle instead
+    float r = BRICK_CORNER_RADIUS, cx = a - r, cy = b - r;
+    if (t*adx <= cx || t*ady <= cy) return t;
+    float dc = adx*cx + ady*cy;
+    return dc + sqrtf(dc*dc - (cx*cx + cy*cy - r*r));
+}
+
+void initBrickShapeTables() {
+    if (shapeTablesReady) return;
+    for (int s = 0; s < BRICK_SHAPE_COUNT; ++s) {
+        BrickShapeSample (*tab)[BRICK_SDF_W] = shapeTables[s];
+        for (int y = 0; y < BRICK_SDF_H; ++y) {
+            for (int x = 0; x < BRICK_SDF_W; ++x) {
+                float px = x - BRICK_SDF_MARGIN - BRICK_XSIZE/2.0f;
+                float py = y - BRICK_SDF_MARGIN - BRICK_YSIZE/2.0f;
+                tab[y][x].dist = shapeDistance(s, px, py);
+            }
+        }
+        // Normals are the gradient of the distance field
+        for (int y = 0; y < BRICK_SDF_H; ++y) {
+            for (int x = 0; x < BRICK_SDF_W; ++x) {
+                int x0 = std::max(x-1, 0), x1 = std::min(x+1, BRICK_SDF_W-1);
+                int y0 = std::max(y-1, 0), y1 = std::min(y+1, BRICK_SDF_H-1);
+                float gx = (tab[y][x1].dist - tab[y][x0].dist) / (x1 - x0);
+                float gy = (tab[y1][x].dist - tab[y0][x].dist) / (y1 - y0);
+                float len = sqrtf(gx*gx + gy*gy);
+                if (len < 1e-6f) { gx = 0; gy = -1; len = 1; } // centre of a symmetric shape
+                tab[y][x].nx = gx / len;
+                tab[y][x].ny = gy / len;
+            }
+        }
+        for (int k = 0; k < BRICK_OUTLINE_POINTS; ++k) {
+            float t = k * (2.0f * (float)M_PI / BRICK_OUTLINE_POINTS);
+            float r = outlineRadius(s, cosf(t), sinf(t));
+            shapeOutlines[s][k][0] = r * cosf(t);
+            shapeOutlines[s][k][1] = r * sinf(t);
+        }
+    }
+    shapeTablesReady = true;
+}
+
+void brickShapeOutline(int shape, int k, float *x, float *y) {
+    if (shape < 0 || shape >= BRICK_SHAPE_COUNT) shape = BRICK_SHAPE_RECT;
+    *x = shapeOutlines[shape][k][0];
+    *y = shapeOutlines[shape][k][1];
+}
+
+bool sampleBrickShape(int shape, double x, double y, BrickShapeSample *out) {
+    if (shape < 0 || shape >= BRICK_SHAPE_COUNT) shape = BRICK_SHAPE_RECT;
+    int tx = (int)lround(x) + BRICK_SDF_MARGIN;
+    int ty = (int)lround(y) + BRICK_SDF_MARGIN;
+    if (tx < 0 || ty < 0 || tx >= BRICK_SDF_W || ty >= BRICK_SDF_H) return false;
+    *out = shapeTables[shape][ty][tx];
+    return true;
+}
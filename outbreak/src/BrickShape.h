@@ -0,0 +1,39 @@
+#ifndef __BRICKSHAPE_H
+#define __BRICKSHAPE_H
+
+#include "Game.h"
+
+// Values stored in Game::brickShapes / Game::brickWallShape
+#define BRICK_SHAPE_RECT 0
+#define BRICK_SHAPE_ELLIPSE 1
+#define BRICK_SHAPE_ROUNDED 2
+#define BRICK_SHAPE_COUNT 3
+
+#define BRICK_CORNER_RADIUS 10
+// Extra pixels sampled around each brick, must be >= ball radius
+#define BRICK_SDF_MARGIN 12
+#define BRICK_SDF_W (BRICK_XSIZE + 2*BRICK_SDF_MARGIN + 1)
+#define BRICK_SDF_H (BRICK_YSIZE + 2*BRICK_SDF_MARGIN + 1)
+// Outline samples per shape, at the same angles for every shape so two
+// outlines can be blended point by point
+#define BRICK_OUTLINE_POINTS 128
+
+/*
+  Signed distance from a brick-local point to the outline of the shape
+  (negative inside) and the outward surface normal at that point.
+*/
+struct BrickShapeSample {
+    float dist;
+    float nx, ny;
+};
+
+// Fills the per-shape distance/normal tables, call once at startup
+void initBrickShapeTables();
+
+// Looks up brick-local (x,y); returns false if the point is off the table
+bool sampleBrickShape(int shape, double x, double y, BrickShapeSample *out);
+
+// Outline point k of shape, relative to the brick centre
+void brickShapeOutline(int shape, int k, float *x, float *y);
+
+#endif // __BRICKSHAPE_H
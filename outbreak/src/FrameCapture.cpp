@@ -0,0 +1,162 @@
+#include "FrameCapture.h"
+#include <SDL2/SDL_image.h>
+#include <algorithm>
+
+#include <stdio.h>
+#include <string.h>
+
+FrameCapture::FrameCapture(const char *path_, int width_, int height_, int fps_)
+    : path(path_), width(width_), height(height_), fps(fps_) {
+    y4m = path.size() >= 4 && path.compare(path.size() - 4, 4, ".y4m") == 0;
+    if (!y4m && !validPattern(path.c_str())) {
+        printf("[CAPTURE] %s needs exactly one integer conversion like %%05d for the frame number\n", path.c_str());
+        return;
+    }
+    if (y4m) {
+        video = fopen(path.c_str(), "wb");
+        if (!video) {
+            printf("[CAPTURE] could not open %s\n", path.c_str());
+            return;
+        }
+        // C420jpeg is only chroma siting; the range has to be spelled out
+        fprintf(video, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg XCOLORRANGE=FULL\n", width, height, fps);
+        int cw = (width + 1) / 2, ch = (height + 1) / 2;
+        yuv.resize(width * height + 2 * cw * ch);
+    }
+    for (int i = 0; i < CAPTURE_POOL_SIZE; ++i) {
+        pool[i].rgba.resize(width * height * 4);
+        freeFrames.push_back(&pool[i]);
+    }
+    opened = true;
+    writer = std::thread(&FrameCapture::writerLoop, this);
+}
+
+FrameCapture::~FrameCapture() {
+    close();
+}
+
+bool FrameCapture::close() {
+    if (!opened) return false;
+    if (!closed) {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        frameReady.notify_one();
+        writer.join();
+        if (video && fclose(video) != 0) errors++;
+        video = NULL;
+        closed = true;
+        printf("[CAPTURE] wrote %d frames to %s, %d errors\n", frameCount, path.c_str(), errors.load());
+    }
+    return errors == 0;
+}
+
+// Accepts one %d/%i/%u (with flags, width, precision) plus any number of %%
+bool FrameCapture::validPattern(const char *pattern) {
+    int conversions = 0;
+    for (const char *p = pattern; *p; ++p) {
+        if (*p != '%') continue;
+        if (*++p == '%') continue;
+        while (*p && strchr("-+ #0", *p)) ++p;
+        while (*p >= '0' && *p <= '9') ++p;
+        if (*p == '.') {
+            ++p;
+            while (*p >= '0' && *p <= '9') ++p;
+        }
+        if (!*p || !strchr("diu", *p)) return false;
+        conversions++;
+    }
+    return conversions == 1;
+}
+
+void FrameCapture::captureFrame(SDL_Renderer *ren) {
+    if (!opened || closed) return;
+    Frame *f;
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        frameFreed.wait(guard, [this] { return !freeFrames.empty(); });
+        f = freeFrames.front();
+        freeFrames.pop_front();
+    }
+    f->index = frameCount++;
+    if (SDL_RenderReadPixels(ren, NULL, SDL_PIXELFORMAT_RGBA32, f->rgba.data(), width * 4) != 0) {
+        printf("[CAPTURE] readback failed: %s\n", SDL_GetError());
+        errors++;
+    }
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        readyFrames.push_back(f);
+    }
+    frameReady.notify_one();
+}
+
+void FrameCapture::writerLoop() {
+    for (;;) {
+        Frame *f;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            frameReady.wait(guard, [this] { return stopping || !readyFrames.empty(); });
+            if (readyFrames.empty()) return; // stopping and drained
+            f = readyFrames.front();
+            readyFrames.pop_front();
+        }
+        if (y4m) writeY4M(*f);
+        else writePNG(*f);
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            freeFrames.push_back(f);
+        }
+        frameFreed.notify_one();
+    }
+}
+
+void FrameCapture::writePNG(const Frame &f) {
+    char name[1024];
+    snprintf(name, sizeof(name), path.c_str(), f.index);
+    SDL_Surface *surf = SDL_CreateRGBSurfaceWithFormatFrom((void *)f.rgba.data(), width, height, 32,
+                                                           width * 4, SDL_PIXELFORMAT_RGBA32);
+    if (!surf || IMG_SavePNG(surf, name) != 0) {
+        printf("[CAPTURE] could not write %s: %s\n", name, SDL_GetError());
+        errors++;
+    }
+    SDL_FreeSurface(surf);
+}
+
+// Full-range BT.601 (flagged XCOLORRANGE=FULL in the header), chroma averaged over 2x2 blocks
+void FrameCapture::writeY4M(const Frame &f) {
+    int cw = (width + 1) / 2, ch = (height + 1) / 2;
+    Uint8 *py = yuv.data();
+    Uint8 *pu = py + width * height;
+    Uint8 *pv = pu + cw * ch;
+    const Uint8 *src = f.rgba.data();
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const Uint8 *p = src + (y * width + x) * 4;
+            py[y * width + x] = (Uint8)((77 * p[0] + 150 * p[1] + 29 * p[2] + 128) >> 8);
+        }
+    }
+    for (int cy = 0; cy < ch; ++cy) {
+        for (int cx = 0; cx < cw; ++cx) {
+            int r = 0, g = 0, b = 0, n = 0;
+            for (int dy = 0; dy < 2; ++dy) {
+                for (int dx = 0; dx < 2; ++dx) {
+                    int x = cx * 2 + dx, y = cy * 2 + dy;
+                    if (x >= width || y >= height) continue;
+                    const Uint8 *p = src + (y * width + x) * 4;
+                    r += p[0]; g += p[1]; b += p[2]; n++;
+                }
+            }
+            r /= n; g /= n; b /= n;
+            int u = 128 + ((-43 * r - 85 * g + 128 * b + 128) >> 8);
+            int v = 128 + ((128 * r - 107 * g - 21 * b + 128) >> 8);
+            pu[cy * cw + cx] = (Uint8)std::min(std::max(u, 0), 255);
+            pv[cy * cw + cx] = (Uint8)std::min(std::max(v, 0), 255);
+        }
+    }
+    fputs("FRAME\n", video);
+    if (fwrite(yuv.data(), 1, yuv.size(), video) != yuv.size()) {
+        printf("[CAPTURE] could not write frame %d to %s\n", f.index, path.c_str());
+        errors++;
+    }
+}
@@ -0,0 +1,66 @@
+#ifndef __FRAMECAPTURE_H
+#define __FRAMECAPTURE_H
+
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Number of frame buffers shared between the render loop and the writer
+#define CAPTURE_POOL_SIZE 8
+
+/*
+  Streams rendered frames to disk off the render thread.
+
+  A path ending in ".y4m" writes one raw YUV4MPEG2 (4:2:0) video, anything
+  else is a printf-style pattern for a PNG sequence, e.g. "out/f%05d.png",
+  with exactly one integer conversion for the frame number.
+  The render loop only blocks if the writer falls CAPTURE_POOL_SIZE frames
+  behind, so no frame is ever dropped.
+*/
+struct FrameCapture {
+    FrameCapture(const char *path, int width, int height, int fps);
+    ~FrameCapture();
+
+    bool isOpen() const { return opened; }
+    // Flushes queued frames; false if any frame failed to read or write
+    bool close();
+    // Reads back the current render target; call before SDL_RenderPresent
+    void captureFrame(SDL_Renderer *ren);
+
+private:
+    struct Frame {
+        int index;
+        std::vector<Uint8> rgba;
+    };
+
+    static bool validPattern(const char *pattern);
+    void writerLoop();
+    void writePNG(const Frame &f);
+    void writeY4M(const Frame &f);
+
+    std::string path;
+    int width, height, fps;
+    bool y4m;
+    bool opened = false;
+    bool closed = false;
+    std::atomic<int> errors{0};
+    FILE *video = NULL;
+    int frameCount = 0;
+    std::vector<Uint8> yuv; // writer-thread scratch for Y4M conversion
+
+    Frame pool[CAPTURE_POOL_SIZE];
+    std::deque<Frame *> freeFrames;
+    std::deque<Frame *> readyFrames;
+    std::mutex lock;
+    std::condition_variable frameFreed;
+    std::condition_variable frameReady;
+    bool stopping = false;
+    std::thread writer;
+};
+
+#endif // __FRAMECAPTURE_H
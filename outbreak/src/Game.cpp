@@ -1,4 +1,6 @@
 #include "Game.h"
+#include "BrickShape.h"
+#include "FrameCapture.h"
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
 #include <algorithm>
@@ -8,6 +10,7 @@
 
 SDL_Window *win;
 SDL_Renderer *ren;
+SDL_Surface *capture_surf; // headless render target while capturing
 
 SDL_Texture *bg_tex;
 SDL_Texture *ball_tex;
@@ -44,30 +47,76 @@ double ballinerti = 0, ballinertj = 0;
 
 int brickWorld[BRICKS_X][BRICKS_Y];
 
+static Uint32 randState = 2463534242u;
+
+void gameSeed(Uint32 seed) {
+    randState = seed ? seed : 2463534242u; // xorshift is stuck at zero
+}
+
+Uint32 gameRand() {
+    randState ^= randState << 13;
+    randState ^= randState >> 17;
+    randState ^= randState << 5;
+    return randState;
+}
+
 /* TODO(satish): Error handling */
-Game::Game() {
-    SDL_Init(SDL_INIT_EVERYTHING);
-    win = SDL_CreateWindow("OutBreak", 100, 100, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
-    ren = SDL_CreateRenderer(win, -1, SDL_RENDERER_ACCELERATED); // Removed VSYNC for lower latency
+Game::Game(const GameOptions &opts) : options(opts) {
+    if (options.capturePath) {
+        // Headless: software renderer into a plain surface, no window or display needed
+        SDL_Init(SDL_INIT_TIMER | SDL_INIT_EVENTS);
+        capture_surf = SDL_CreateRGBSurfaceWithFormat(0, SCREEN_WIDTH, SCREEN_HEIGHT, 32, SDL_PIXELFORMAT_RGBA32);
+        if (!capture_surf) {
+            printf("[CAPTURE] could not create render surface: %s\n", SDL_GetError());
+            failed = true;
+            return;
+        }
+        ren = SDL_CreateSoftwareRenderer(capture_surf);
+        if (!ren) {
+            printf("[CAPTURE] could not create software renderer: %s\n", SDL_GetError());
+            failed = true;
+            return;
+        }
+        capture = new FrameCapture(options.capturePath, SCREEN_WIDTH, SCREEN_HEIGHT, options.captureFps);
+        if (!capture->isOpen()) {
+            failed = true;
+            return;
+        }
+    } else {
+        SDL_Init(SDL_INIT_EVERYTHING);
+        win = SDL_CreateWindow("OutBreak", 100, 100, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+        ren = SDL_CreateRenderer(win, -1, SDL_RENDERER_ACCELERATED); // Removed VSYNC for lower latency
+    }
 
     bg_tex = IMG_LoadTexture(ren, BG_IMG);
     ball_tex = IMG_LoadTexture(ren, BALL_IMG);
     paddle_tex = IMG_LoadTexture(ren, PADDLE_IMG);
     brick_tex = IMG_LoadTexture(ren, BRICK_IMG);
 
+    initBrickShapeTables();
     mainLoop();
+    // Flush here so main can report a failed capture
+    if (capture && !capture->close()) failed = true;
 }
 
 Game::~Game() {
+    delete capture; // flushes frames still queued for the writer
     SDL_DestroyTexture(bg_tex);
     SDL_DestroyTexture(ball_tex);
     SDL_DestroyTexture(paddle_tex);
     SDL_DestroyTexture(brick_tex);
-    SDL_DestroyWindow(win);
+    if (win) SDL_DestroyWindow(win);
     SDL_DestroyRenderer(ren);
+    if (capture_surf) SDL_FreeSurface(capture_surf);
     SDL_Quit();
 }
 
+// Game clock: wall time normally, frame count when capturing so output is reproducible
+Uint32 Game::ticks() {
+    if (capture) return (Uint32)((Uint64)frameIndex * 1000 / options.captureFps);
+    return SDL_GetTicks();
+}
+
 void renderTexture(SDL_Texture *tex, SDL_Renderer *ren, int x, int y, int w, int h) {
     SDL_Rect dest;
     dest.x = x; dest.y = y; dest.w = w; dest.h = h;
@@ -103,7 +152,7 @@ void Game::detectCollisions() {
     if (!ballInPlay) return;
     // Paddle collision (AABB)
     if (!ballHasClearedPaddle) return; // Only allow paddle collision if ball has cleared paddle
-    if (paddleCollisionCooldown > 0) return; // Skip paddle collision if cooldown is active
+    if (anims.active(paddleCooldown)) return; // Skip paddle collision if cooldown is active
     bool paddle_x = (ballposi + BALL_SIZE > paddleposi) && (ballposi < paddleposi + PADDLE_XSIZE);
     bool paddle_y = (ballposj + BALL_SIZE > paddleposj) && (ballposj < paddleposj + PADDLE_YSIZE);
     if (paddle_x && paddle_y) {
@@ -114,16 +163,16 @@ void Game::detectCollisions() {
         double hit_pos = (ballposi + BALL_SIZE/2.0) - (paddleposi + PADDLE_XSIZE/2.0);
         double norm = hit_pos / (PADDLE_XSIZE/2.0); // -1 (left) to 1 (right)
         int new_xdir = (int)round(norm * 2); // -2, -1, 0, 1, 2
-        if (new_xdir == 0) new_xdir = (rand()%2==0) ? -1 : 1; // avoid vertical lock
+        if (new_xdir == 0) new_xdir = (gameRand()%2==0) ? -1 : 1; // avoid vertical lock
         ballinerti = new_xdir;
         // Enforce minimum horizontal velocity for escape
         if (fabs(ballinerti) < 1e-2) {
-            ballinerti = (rand()%2==0) ? -1 : 1;
+            ballinerti = (gameRand()%2==0) ? -1 : 1;
         } else if (abs(ballinerti) < 1) {
             ballinerti = (ballinerti < 0) ? -1 : 1;
         }
         // Add a small random nudge if exactly zero
-        if (ballinerti == 0) ballinerti = (rand()%2==0) ? -1 : 1;
+        if (ballinerti == 0) ballinerti = (gameRand()%2==0) ? -1 : 1;
         // Strong springy rebound: always a strong upward direction
         ballinertj = -1.5;
         if (std::isnan(ballinertj) || std::isinf(ballinertj) || fabs(ballinertj) < 1e-3) {
@@ -134,74 +183,89 @@ void Game::detectCollisions() {
 
         justBouncedPaddle = true;
         ballHasClearedPaddle = false;
-        paddleCollisionCooldown = 0.12; // 120 ms cooldown to prevent sticking
+        paddleCooldown = anims.timer(120, animClearHandle, &paddleCooldown); // 120 ms cooldown to prevent sticking
         if (std::isnan(ballinertj) || std::isinf(ballinertj) || fabs(ballinertj) < 1e-3) {
             printf("[DEBUG] ballinertj was nan, inf, or zero, resetting to -3.5\n");
             ballinertj = -3.5;
         }
         if (std::isnan(ballinerti) || std::isinf(ballinerti)) {
             printf("[DEBUG] ballinerti was nan or inf, resetting to random direction\n");
-            ballinerti = (rand()%2==0) ? -1 : 1;
+            ballinerti = (gameRand()%2==0) ? -1 : 1;
         }
         printf("[DEBUG] Paddle collision: ballposj=%.2f paddleposj=%.2f ballinertj=%.2f\n", ballposj, paddleposj, ballinertj);
         return;
     }
 
     // Wall collisions
+    // Flip the sign only so the angle survives the bounce
     if (ballposi <= 0) {
         ballposi = 0;
-        ballinerti = 1;
+        ballinerti = fabs(ballinerti);
     } else if ((ballposi + BALL_SIZE) >= SCREEN_WIDTH) {
         ballposi = SCREEN_WIDTH - BALL_SIZE;
-        ballinerti = -1;
+        ballinerti = -fabs(ballinerti);
     }
     if (ballposj <= 0) {
         ballposj = 0;
-        ballinertj = 1;
+        ballinertj = fabs(ballinertj);
         if (std::isnan(ballinertj) || std::isinf(ballinertj)) { printf("[DEBUG] ballinertj nan/inf in detectCollisions (brick), resetting to 1\n"); ballinertj = 1; }
     } else if ((ballposj + BALL_SIZE) >= SCREEN_HEIGHT) {
         resetBall();
         return;
     }
 
-    // Brick collisions (AABB)
+    // Brick collisions, against the shape as drawn
     int wall_width = BRICKS_X * BRICK_XSIZE + (BRICKS_X - 1) * BRICK_WORLD_X_PADDING;
     int start_x = (SCREEN_WIDTH - wall_width) / 2;
+    // Sweep the ball centre along last frame's step, prev -> current, in
+    // steps under the ball radius, and take the earliest contact. Testing
+    // only the end point lets a fast ball cross a brick's midline and get
+    // pushed out of the far side.
+    double ball_r = BALL_SIZE/2.0;
+    double x0 = prev_ballposi + ball_r, y0 = prev_ballposj + ball_r;
+    double x1 = ballposi + ball_r, y1 = ballposj + ball_r;
+    int steps = std::max(1, (int)ceil(std::max(fabs(x1 - x0), fabs(y1 - y0)) / 2.0));
+    int hit_i = -1, hit_j = -1, hit_step = steps + 1;
+    BrickShapeSample hit;
     for(int j=0; j<BRICKS_Y; j++) {
         for(int i=0; i<BRICKS_X; i++) {
-            if(brickWorld[i][j] != 0) {
-                int brick_x = start_x + i * (BRICK_XSIZE + BRICK_WORLD_X_PADDING);
-                int brick_y = BRICK_WORLD_Y_PADDING + j * (BRICK_YSIZE + BRICK_WORLD_Y_PADDING);
-                bool x_collides = (ballposi + BALL_SIZE > brick_x && ballposi < (brick_x + BRICK_XSIZE));
-                bool y_collides = (ballposj + BALL_SIZE > brick_y && ballposj < (brick_y + BRICK_YSIZE));
-                if (x_collides && y_collides) {
-                    destroyBrick(i,j);
-                    // Push ball out of brick
-                    if (prev_ballposj + BALL_SIZE <= brick_y) {
-                        // Came from above
-                        ballposj = brick_y - BALL_SIZE;
-                        ballinertj = -ballinertj;
-                    } else if (prev_ballposj >= brick_y + BRICK_YSIZE) {
-                        // Came from below
-                        ballposj = brick_y + BRICK_YSIZE;
-                        ballinertj = -ballinertj;
-                    } else if (prev_ballposi + BALL_SIZE <= brick_x) {
-                        // Came from left
-                        ballposi = brick_x - BALL_SIZE;
-                        ballinerti = -ballinerti;
-                    } else if (prev_ballposi >= brick_x + BRICK_XSIZE) {
-                        // Came from right
-                        ballposi = brick_x + BRICK_XSIZE;
-                        ballinerti = -ballinerti;
-                    } else {
-                        // Default: vertical bounce
-                        ballinertj = -ballinertj;
-                    }
-                    return;
-                }
+            if(brickWorld[i][j] == 0) continue;
+            int brick_x = start_x + i * (BRICK_XSIZE + BRICK_WORLD_X_PADDING);
+            int brick_y = BRICK_WORLD_Y_PADDING + j * (BRICK_YSIZE + BRICK_WORLD_Y_PADDING);
+            // Skip bricks the swept ball can't reach
+            if (std::max(x0, x1) + ball_r < brick_x || std::min(x0, x1) - ball_r > brick_x + BRICK_XSIZE) continue;
+            if (std::max(y0, y1) + ball_r < brick_y || std::min(y0, y1) - ball_r > brick_y + BRICK_YSIZE) continue;
+            for (int s = 0; s <= steps && s < hit_step; ++s) {
+                double t = (double)s / steps;
+                BrickShapeSample sample;
+                if (!sampleBrickShape(brickShapes[i][j], x0 + (x1 - x0)*t - brick_x, y0 + (y1 - y0)*t - brick_y, &sample)) continue;
+                if (sample.dist >= ball_r) continue;
+                hit_i = i; hit_j = j; hit_step = s; hit = sample;
+                break;
             }
         }
     }
+    if (hit_i < 0) return;
+    destroyBrick(hit_i, hit_j);
+    // Back up to the contact point, then push out along the surface normal
+    double t = (double)hit_step / steps;
+    ballposi = x0 + (x1 - x0)*t - ball_r + hit.nx * (ball_r - hit.dist + 0.5);
+    ballposj = y0 + (y1 - y0)*t - ball_r + hit.ny * (ball_r - hit.dist + 0.5);
+    // Reflect about the normal if moving into the surface
+    double vn = ballinerti * hit.nx + ballinertj * hit.ny;
+    if (vn < 0) {
+        ballinerti -= 2 * vn * hit.nx;
+        ballinertj -= 2 * vn * hit.ny;
+    }
+    // Corner hits can send the ball nearly flat, keep some vertical travel
+    double speed = sqrt(ballinerti*ballinerti + ballinertj*ballinertj);
+    double min_j = 0.35 * speed;
+    if (fabs(ballinertj) < min_j) {
+        double sign_j = (ballinertj < 0 || (ballinertj == 0 && hit.ny < 0)) ? -1 : 1;
+        double sign_i = (ballinerti < 0) ? -1 : 1;
+        ballinertj = sign_j * min_j;
+        ballinerti = sign_i * sqrt(speed*speed - min_j*min_j);
+    }
 }
 
 /*
@@ -290,18 +354,23 @@ void Game::movePaddle(double xdir, double delta) {
 
 void Game::setupBrickWorld() {
     // Only use rounded rectangles for bricks
-    brickWallShape = 2;
+    brickWallShape = BRICK_SHAPE_ROUNDED;
     for(int j=0; j<BRICKS_Y; j++) {
         for(int i=0; i<BRICKS_X; i++) {
-            if (rand() % 100 < 15) {
+            anims.cancel(brickTint[i][j]);
+            anims.cancel(brickMorph[i][j]);
+            anims.cancel(brickScale[i][j]);
+            brickTint[i][j] = brickMorph[i][j] = brickScale[i][j] = 0;
+            if (gameRand() % 100 < 15) {
                 brickWorld[i][j] = 0;
             } else {
                 brickWorld[i][j] = 1;
                 brickHP[i][j] = 2; // 2 hits to break
+                brickShapes[i][j] = brickWallShape;
                 // Random color
-                brickColors[i][j].r = rand() % 256;
-                brickColors[i][j].g = rand() % 256;
-                brickColors[i][j].b = rand() % 256;
+                brickColors[i][j].r = gameRand() % 256;
+                brickColors[i][j].g = gameRand() % 256;
+                brickColors[i][j].b = gameRand() % 256;
                 brickColors[i][j].a = 255;
             }
         }
@@ -309,14 +378,45 @@ void Game::setupBrickWorld() {
 }
 
 void Game::destroyBrick(int i, int j) {
+    int id = i * BRICKS_Y + j;
     if (brickHP[i][j] > 1) {
         brickHP[i][j]--;
+        // Fade to a darker colour and morph into an ellipse
+        SDL_Color c = brickColors[i][j];
+        float from[4] = { (float)c.r, (float)c.g, (float)c.b, (float)c.a };
+        float to[4] = { c.r * 0.5f, c.g * 0.5f, c.b * 0.5f, (float)c.a };
+        anims.cancel(brickTint[i][j]);
+        brickTint[i][j] = anims.tween(200, from, to, onBrickTinted, this, id);
+        if (brickShapes[i][j] != BRICK_SHAPE_ELLIPSE) {
+            float m0[4] = { 0, 0, 0, 0 }, m1[4] = { 1, 0, 0, 0 };
+            anims.cancel(brickMorph[i][j]);
+            brickMorphShape[i][j] = BRICK_SHAPE_ELLIPSE;
+            brickMorph[i][j] = anims.tween(300, m0, m1, onBrickMorphed, this, id);
+        }
     } else {
         brickWorld[i][j] = 0;
         brickHP[i][j] = 0;
+        // Gone for collisions right away, shrinks out on screen
+        float from[4] = { 1, 0, 0, 0 }, to[4] = { 0, 0, 0, 0 };
+        brickScale[i][j] = anims.tween(150, from, to, animClearHandle, &brickScale[i][j]);
     }
 }
 
+void Game::onBrickTinted(void *ctx, int id, const float *value) {
+    Game *game = (Game *)ctx;
+    game->brickTint[id / BRICKS_Y][id % BRICKS_Y] = 0;
+    SDL_Color &c = game->brickColors[id / BRICKS_Y][id % BRICKS_Y];
+    c.r = (Uint8)value[0]; c.g = (Uint8)value[1]; c.b = (Uint8)value[2]; c.a = (Uint8)value[3];
+}
+
+// Collisions keep the old shape until the morph completes
+void Game::onBrickMorphed(void *ctx, int id, const float *) {
+    Game *game = (Game *)ctx;
+    int i = id / BRICKS_Y, j = id % BRICKS_Y;
+    game->brickMorph[i][j] = 0;
+    game->brickShapes[i][j] = game->brickMorphShape[i][j];
+}
+
 void Game::handleInput(double delta) {
     // Only restrict input if not waitingToServe and not ballInPlay
     if (!ballInPlay && !waitingToServe) {
@@ -325,9 +425,7 @@ void Game::handleInput(double delta) {
     }
     // Double-tap detection for acceleration burst
     static const double DOUBLE_TAP_WINDOW = 0.22; // seconds
-    static double paddleBoostTimer = 0.0;
-    static int paddleBoostDir = 0; // -1=left, 1=right
-    Uint32 now = SDL_GetTicks();
+    Uint32 now = ticks();
 
     SDL_Event event;
     // Handle discrete events (like quit)
@@ -347,29 +445,42 @@ void Game::handleInput(double delta) {
     const Uint8* keyState = SDL_GetKeyboardState(NULL);
     bool left = keyState[SDL_SCANCODE_LEFT];
     bool right = keyState[SDL_SCANCODE_RIGHT];
+    bool up = keyState[SDL_SCANCODE_UP];
+    if (options.autoPlay) {
+        // Attract mode: chase the ball and serve straight away
+        double target = ballposi + BALL_SIZE/2.0 - PADDLE_XSIZE/2.0;
+        left = target < paddleposi - 4;
+        right = target > paddleposi + 4;
+        up = true;
+    }
 
-    // Double-tap logic
+    // Double-tap logic, on new presses only so a held key doesn't restart the boost
     double speedMultiplier = 1.0;
-    if (left && !right) {
+    bool holdLeft = left && !right, holdRight = right && !left;
+    if (holdLeft && !paddleKeyHeld[0]) {
         if (now - lastPaddlePressTime[0] < DOUBLE_TAP_WINDOW * 1000) {
-            paddleBoostTimer = 0.18; // 180 ms boost
+            anims.cancel(paddleBoost);
+            paddleBoost = anims.timer(180, animClearHandle, &paddleBoost); // 180 ms boost
             paddleBoostDir = -1;
         }
         lastPaddlePressTime[0] = now;
-    } else if (right && !left) {
+    } else if (holdRight && !paddleKeyHeld[1]) {
         if (now - lastPaddlePressTime[1] < DOUBLE_TAP_WINDOW * 1000) {
-            paddleBoostTimer = 0.18;
+            anims.cancel(paddleBoost);
+            paddleBoost = anims.timer(180, animClearHandle, &paddleBoost);
             paddleBoostDir = 1;
         }
         lastPaddlePressTime[1] = now;
     }
-    if (paddleBoostTimer > 0) {
+    paddleKeyHeld[0] = holdLeft;
+    paddleKeyHeld[1] = holdRight;
+    if (anims.active(paddleBoost)) {
         speedMultiplier = 1.8;
-        paddleBoostTimer -= delta;
         if ((left && paddleBoostDir == -1) || (right && paddleBoostDir == 1)) {
             // keep boosting
         } else {
-            paddleBoostTimer = 0;
+            anims.cancel(paddleBoost);
+            paddleBoost = 0;
         }
     }
     // Move paddle with boost
@@ -386,7 +497,7 @@ void Game::handleInput(double delta) {
         paddleaccr = 1.0;
     }
 
-    if (keyState[SDL_SCANCODE_UP] && waitingToServe) {
+    if (up && waitingToServe) {
         ballposi = paddleposi + PADDLE_XSIZE/2;
         ballposj = paddleposj - PADDLE_YSIZE;
         ballinerti = 1; ballinertj = -1;
@@ -408,16 +519,16 @@ static Uint32 bg_start_ticks = 0;
 void Game::renderWorld() {
     if (!stars_initialized) {
         // Pick a random mode at game start
-        backgroundMode = rand() % 4;
-        bg_start_ticks = SDL_GetTicks();
+        backgroundMode = (options.background >= 0) ? options.background % 4 : gameRand() % 4;
+        bg_start_ticks = ticks();
         // Init stars
         stars.clear();
         for (int i = 0; i < 80; ++i) {
-            stars.push_back({(float)(rand()%SCREEN_WIDTH), (float)(rand()%SCREEN_HEIGHT), 0.5f + 2.5f*(rand()/(float)RAND_MAX), (float)(128 + rand()%128), (rand()%2) ? 1.0f : -1.0f});
+            stars.push_back({(float)(gameRand()%SCREEN_WIDTH), (float)(gameRand()%SCREEN_HEIGHT), 0.5f + 2.5f*(gameRand()/(float)GAME_RAND_MAX), (float)(128 + gameRand()%128), (gameRand()%2) ? 1.0f : -1.0f});
         }
         stars_initialized = true;
     }
-    Uint32 ticks = SDL_GetTicks() - bg_start_ticks;
+    Uint32 ticks = this->ticks() - bg_start_ticks;
     switch (backgroundMode) {
         case 0: // Blinking (twinkling) stars
         {
@@ -425,9 +536,9 @@ void Game::renderWorld() {
             SDL_RenderClear(ren);
             for (auto& s : stars) {
                 s.y += s.speed;
-                if (s.y > SCREEN_HEIGHT) { s.y = 0; s.x = rand()%SCREEN_WIDTH; s.speed = 0.5f + 2.5f*(rand()/(float)RAND_MAX); }
+                if (s.y > SCREEN_HEIGHT) { s.y = 0; s.x = gameRand()%SCREEN_WIDTH; s.speed = 0.5f + 2.5f*(gameRand()/(float)GAME_RAND_MAX); }
                 // Twinkle
-                s.alpha += s.alpha_dir * (1.5f + rand()%2) * (0.6f + 0.4f * sinf(ticks/800.0f));
+                s.alpha += s.alpha_dir * (1.5f + gameRand()%2) * (0.6f + 0.4f * sinf(ticks/800.0f));
                 if (s.alpha > 255) { s.alpha = 255; s.alpha_dir = -1.0f; }
                 if (s.alpha < 80) { s.alpha = 80; s.alpha_dir = 1.0f; }
                 filledCircleRGBA(ren, (int)s.x, (int)s.y, 1 + (int)(s.speed/1.5), 180, 200, 255, (Uint8)(s.alpha * 0.7)); // blue-white, lower alpha
@@ -485,52 +596,93 @@ void Game::renderPaddle() {
     boxRGBA(ren, (int)paddleposi + 10, (int)paddleposj + 3, (int)(paddleposi + PADDLE_XSIZE - 10), (int)(paddleposj + PADDLE_YSIZE/3), 255, 255, 255, 70);
 }
 
+// Glow and body of one brick shape filling the box (x0,y0)-(x1,y1)
+static void drawBrickShape(int shape, int x0, int y0, int x1, int y1, SDL_Color c, Uint8 alpha) {
+    Uint8 glow = (Uint8)(40 * alpha / 255);
+    if (shape == BRICK_SHAPE_ELLIPSE) {
+        int cx = (x0 + x1)/2, cy = (y0 + y1)/2;
+        filledEllipseRGBA(ren, cx, cy, (x1 - x0)/2+4, (y1 - y0)/2+4, c.r, c.g, c.b, glow);
+        filledEllipseRGBA(ren, cx, cy, (x1 - x0)/2, (y1 - y0)/2, c.r, c.g, c.b, alpha);
+    } else if (shape == BRICK_SHAPE_RECT) {
+        boxRGBA(ren, x0-4, y0-4, x1+4, y1+4, c.r, c.g, c.b, glow);
+        boxRGBA(ren, x0, y0, x1, y1, c.r, c.g, c.b, alpha);
+    } else {
+        int radius = std::min(BRICK_CORNER_RADIUS, std::min(x1 - x0, y1 - y0)/2);
+        // Optional: glow effect
+        roundedBoxRGBA(ren, x0-4, y0-4, x1+4, y1+4, radius+6, c.r, c.g, c.b, glow);
+        // Main brick
+        roundedBoxRGBA(ren, x0, y0, x1, y1, radius, c.r, c.g, c.b, alpha);
+    }
+}
+
+// Blend two outlines point by point and fill the result, glow included
+static void drawBrickMorph(int from, int to, float m, int cx, int cy, float scale, SDL_Color c) {
+    Sint16 vx[BRICK_OUTLINE_POINTS], vy[BRICK_OUTLINE_POINTS];
+    Sint16 gx[BRICK_OUTLINE_POINTS], gy[BRICK_OUTLINE_POINTS];
+    for (int k = 0; k < BRICK_OUTLINE_POINTS; ++k) {
+        float ax, ay, bx, by;
+        brickShapeOutline(from, k, &ax, &ay);
+        brickShapeOutline(to, k, &bx, &by);
+        float x = (ax + (bx - ax) * m) * scale, y = (ay + (by - ay) * m) * scale;
+        float len = sqrtf(x*x + y*y);
+        float grow = (len > 1e-3f) ? (len + 4) / len : 1;
+        vx[k] = (Sint16)(cx + x); vy[k] = (Sint16)(cy + y);
+        gx[k] = (Sint16)(cx + x * grow); gy[k] = (Sint16)(cy + y * grow);
+    }
+    filledPolygonRGBA(ren, gx, gy, BRICK_OUTLINE_POINTS, c.r, c.g, c.b, (Uint8)(40 * c.a / 255));
+    filledPolygonRGBA(ren, vx, vy, BRICK_OUTLINE_POINTS, c.r, c.g, c.b, c.a);
+}
+
 void Game::renderBrickWorld() {
     // Calculate total wall width for centering
     int wall_width = BRICKS_X * BRICK_XSIZE + (BRICKS_X - 1) * BRICK_WORLD_X_PADDING;
     int start_x = (SCREEN_WIDTH - wall_width) / 2;
-    int radius = 10;
+    int radius = BRICK_CORNER_RADIUS;
+    float v[4];
     for(int j=0; j<BRICKS_Y; j++) {
         for(int i=0; i<BRICKS_X; i++) {
-            if(brickWorld[i][j] != 0) {
-                int x = start_x + i * (BRICK_XSIZE + BRICK_WORLD_X_PADDING);
-                int y = BRICK_WORLD_Y_PADDING + j * (BRICK_YSIZE + BRICK_WORLD_Y_PADDING);
-                SDL_Color c = brickColors[i][j];
-                if (brickHP[i][j] == 1) {
-                    // Darken color for damaged brick
-                    c.r = (Uint8)(c.r * 0.5);
-                    c.g = (Uint8)(c.g * 0.5);
-                    c.b = (Uint8)(c.b * 0.5);
-                }
-                // Optional: glow effect
-                roundedBoxRGBA(ren, x-4, y-4, x+BRICK_XSIZE+4, y+BRICK_YSIZE+4, radius+6, c.r, c.g, c.b, 40);
-                // Main brick
-                roundedBoxRGBA(ren, x, y, x+BRICK_XSIZE, y+BRICK_YSIZE, radius, c.r, c.g, c.b, c.a);
-                // Shine: overlay a lighter semi-transparent rounded rect at the top-left
-                Uint8 shine_r = (Uint8)std::min<unsigned int>(255, c.r + 80);
-                Uint8 shine_g = (Uint8)std::min<unsigned int>(255, c.g + 80);
-                Uint8 shine_b = (Uint8)std::min<unsigned int>(255, c.b + 80);
-                int shine_w = BRICK_XSIZE * 0.6;
-                int shine_h = BRICK_YSIZE * 0.4;
-                roundedBoxRGBA(ren, x+3, y+3, x+shine_w, y+shine_h, radius/2, shine_r, shine_g, shine_b, 120);
+            bool dying = anims.sample(brickScale[i][j], v);
+            if(brickWorld[i][j] == 0 && !dying) continue;
+            float scale = dying ? v[0] : 1.0f;
+            int x = start_x + i * (BRICK_XSIZE + BRICK_WORLD_X_PADDING);
+            int y = BRICK_WORLD_Y_PADDING + j * (BRICK_YSIZE + BRICK_WORLD_Y_PADDING);
+            int hw = (int)(BRICK_XSIZE * scale / 2), hh = (int)(BRICK_YSIZE * scale / 2);
+            int cx = x + BRICK_XSIZE/2, cy = y + BRICK_YSIZE/2;
+            SDL_Color c = brickColors[i][j];
+            if (anims.sample(brickTint[i][j], v)) {
+                // Damage fade in progress
+                c.r = (Uint8)v[0]; c.g = (Uint8)v[1]; c.b = (Uint8)v[2]; c.a = (Uint8)v[3];
             }
+            // Draw the same outline detectCollisions tests against
+            int shape = brickShapes[i][j];
+            if (anims.sample(brickMorph[i][j], v)) {
+                drawBrickMorph(shape, brickMorphShape[i][j], v[0], cx, cy, scale, c);
+                continue;
+            }
+            drawBrickShape(shape, cx-hw, cy-hh, cx+hw, cy+hh, c, c.a);
+            if (shape == BRICK_SHAPE_ELLIPSE || dying) continue;
+            // Shine: overlay a lighter semi-transparent rounded rect at the top-left
+            Uint8 shine_r = (Uint8)std::min<unsigned int>(255, c.r + 80);
+            Uint8 shine_g = (Uint8)std::min<unsigned int>(255, c.g + 80);
+            Uint8 shine_b = (Uint8)std::min<unsigned int>(255, c.b + 80);
+            int shine_w = BRICK_XSIZE * 0.6;
+            int shine_h = BRICK_YSIZE * 0.4;
+            roundedBoxRGBA(ren, x+3, y+3, x+shine_w, y+shine_h, radius/2, shine_r, shine_g, shine_b, 120);
         }
     }
 }
 
 void Game::updateState(double delta) {
     justBouncedPaddle = false;
-    prev_ballposi = ballposi;
-    prev_ballposj = ballposj;
     prev_paddleposi = paddleposi;
-    // Decrement paddle collision cooldown
-    if (paddleCollisionCooldown > 0) {
-        paddleCollisionCooldown -= delta;
-        if (paddleCollisionCooldown < 0) paddleCollisionCooldown = 0;
-    }
+    // Fire cooldowns and finished brick effects
+    anims.advance(ticks());
     // Allow paddle collision only after ball has cleared the paddle
     if (ballposj + BALL_SIZE < paddleposj - 20) ballHasClearedPaddle = true; // Increase clearance threshold
     detectCollisions();
+    // Where this frame's move starts; detectCollisions sweeps from here next frame
+    prev_ballposi = ballposi;
+    prev_ballposj = ballposj;
     moveBallWithInertia(delta);
 }
 
@@ -575,7 +727,7 @@ void Game::moveBallWithInertia(double delta) {
     }
     // If the ball is above the paddle and moving down, and paddle is moving toward the ball, slow the ball
     bool close_to_paddle = (ballposj + BALL_SIZE > paddleposj - 1.5*PADDLE_YSIZE) && (ballposj < paddleposj);
-    bool ball_moving_down = (ballinertj == 1);
+    bool ball_moving_down = (ballinertj > 0);
     // Estimate paddle velocity (difference over last frame)
     double paddle_velocity = paddleposi - prev_paddleposi;
     bool paddle_approaching = (paddle_velocity > 0 && ballposi > paddleposi) || (paddle_velocity < 0 && ballposi < paddleposi);
@@ -586,30 +738,14 @@ void Game::moveBallWithInertia(double delta) {
 }
 
 // Helper for custom ball speed
-void Game::moveBallWithSpeed(int xdir, int ydir, double delta, double speed) {
-    double move_amount = speed * delta;
-    if (xdir == 0 && ydir == 0) {          // do nothing
-    } else if (xdir == 0 && ydir == 1) {   // move down
-        ballposj = ((ballposj + move_amount) < SCREEN_HEIGHT) ? (ballposj + move_amount) : (SCREEN_HEIGHT - BALL_SIZE);
-    } else if (xdir == 0 && ydir == -1) {  // move up
-        ballposj = ((ballposj - move_amount) > 0) ? (ballposj - move_amount) : 0;
-    } else if (xdir == -1 && ydir == 0) {  // move left
-        ballposi = ((ballposi - move_amount) > 0) ? (ballposi - move_amount) : 0;
-    } else if (xdir == 1 && ydir == 0) {   // move right
-        ballposi = ((ballposi + move_amount) < SCREEN_WIDTH)? (ballposi + move_amount): (SCREEN_WIDTH-BALL_SIZE);
-    } else if (xdir == -1 && ydir == 1) {  // move upleft
-        ballposj = ((ballposj + move_amount) < SCREEN_HEIGHT) ? (ballposj + move_amount) : (SCREEN_HEIGHT - BALL_SIZE);
-        ballposi = ((ballposi - move_amount) > 0) ? (ballposi - move_amount) : 0;
-    } else if (xdir == -1 && ydir == -1) { // move downleft
-        ballposj = ((ballposj - move_amount) > 0) ? (ballposj - move_amount) : 0;
-        ballposi = ((ballposi - move_amount) > 0) ? (ballposi - move_amount) : 0;
-    } else if (xdir == 1 && ydir == -1) {  // move downright
-        ballposj = ((ballposj - move_amount) > 0) ? (ballposj - move_amount) : 0;
-        ballposi = ((ballposi + move_amount) < SCREEN_WIDTH)? (ballposi + move_amount): (SCREEN_WIDTH-BALL_SIZE);
-    } else if (xdir == 1 && ydir == 1) {   // move upright
-        ballposj = ((ballposj + move_amount) < SCREEN_HEIGHT) ? (ballposj + move_amount) : (SCREEN_HEIGHT - BALL_SIZE);
-        ballposi = ((ballposi + move_amount) < SCREEN_WIDTH)? (ballposi + move_amount): (SCREEN_WIDTH-BALL_SIZE);
-    }
+// The direction is normalised, so only speed sets the pace; speed is per axis
+// on a 45 degree path, the pace the original eight-direction steps moved at
+void Game::moveBallWithSpeed(double xdir, double ydir, double delta, double speed) {
+    double len = sqrt(xdir*xdir + ydir*ydir);
+    if (len < 1e-9) return; // do nothing
+    double move_amount = speed * delta * M_SQRT2 / len;
+    ballposi = std::min(std::max(ballposi + xdir * move_amount, 0.0), (double)(SCREEN_WIDTH - BALL_SIZE));
+    ballposj = std::min(std::max(ballposj + ydir * move_amount, 0.0), (double)(SCREEN_HEIGHT - BALL_SIZE));
 }
 
 void Game::renderFrame() {
@@ -618,11 +754,12 @@ void Game::renderFrame() {
     renderBrickWorld();
     renderBall();
     renderPaddle();
+    if (capture) capture->captureFrame(ren);
     SDL_RenderPresent(ren);
 }
 
 /*
-  - Runs at 60 fps
+  - Runs at 60 fps (fixed step when capturing)
   - Gets input
   - Updates game state
   - Renders a frame
@@ -634,14 +771,22 @@ void Game::mainLoop() {
     Uint32 last_time = SDL_GetTicks();
 
     while (Running) {
-        Uint32 current_time = SDL_GetTicks();
-        double delta = (current_time - last_time) / 1000.0; // seconds
-        if (delta > 0.05) delta = 0.05; // clamp to avoid huge jumps
-        last_time = current_time;
+        double delta;
+        if (capture) {
+            // Fixed step: reproducible, and runs as fast as the CPU allows
+            delta = 1.0 / options.captureFps;
+        } else {
+            Uint32 current_time = SDL_GetTicks();
+            delta = (current_time - last_time) / 1000.0; // seconds
+            if (delta > 0.05) delta = 0.05; // clamp to avoid huge jumps
+            last_time = current_time;
+        }
 
         handleInput(delta);
         updateState(delta);
         renderFrame();
+        frameIndex++;
+        if (capture && frameIndex >= options.captureFrames) Running = false;
     }
 }
 
@@ -3,6 +3,7 @@
 
 #include <SDL2/SDL2_gfxPrimitives.h>
 #include <SDL2/SDL.h>
+#include "Animation.h"
 
 // Brick and world constants (moved from Game.cpp)
 #define BRICK_XSIZE 80
@@ -16,8 +17,25 @@
 #define brick_x_pos(bricki) ((bricki)*((BRICK_WORLD_X_PADDING)+(BRICK_XSIZE)))
 #define brick_y_pos(brickj) ((brickj)*((BRICK_WORLD_Y_PADDING)+(BRICK_YSIZE)))
 
+struct FrameCapture;
+
+// Game-wide PRNG (xorshift32). Unlike rand() it gives the same sequence on
+// every C library, so seeded captures can be compared between machines.
+#define GAME_RAND_MAX 0xffffffffu
+void gameSeed(Uint32 seed);
+Uint32 gameRand();
+
+// Command line settings, see main.cpp
+struct GameOptions {
+    const char *capturePath = NULL; // render headless and capture to this path
+    int captureFrames = 600;        // frames to capture before quitting
+    int captureFps = 60;            // fixed timestep while capturing
+    int background = -1;            // renderWorld mode, -1 = random
+    bool autoPlay = false;          // attract mode: paddle follows the ball
+};
+
 struct Game {
-    Game();
+    Game(const GameOptions &opts = GameOptions());
     ~Game();
 
     void mainLoop();
@@ -31,24 +49,40 @@ struct Game {
     void moveBallWithInertia(double delta);
     void resetBall();
     void moveBall(int, int, double delta);
-    void moveBallWithSpeed(int xdir, int ydir, double delta, double speed);
+    void moveBallWithSpeed(double xdir, double ydir, double delta, double speed);
     void movePaddle(double, double delta);
     void setupBrickWorld();
     void destroyBrick(int,int);
     void detectCollisions();
     void switchBallInertia(int);
+    Uint32 ticks();
+    bool ok() const { return !failed; } // false if headless setup or capture failed
+    static void onBrickTinted(void *ctx, int id, const float *value);
+    static void onBrickMorphed(void *ctx, int id, const float *value);
 
 private:
+    GameOptions options;
+    FrameCapture *capture = NULL;
+    int frameIndex = 0;
+    bool failed = false;
     bool Running = false;
     bool ballInPlay = false;
     bool waitingToServe = true;
-    SDL_Color brickColors[BRICKS_X][BRICKS_Y];
-    int brickShapes[BRICKS_X][BRICKS_Y]; // 0=rect, 1=ellipse, 2=rounded rect
-    int brickWallShape; // 0=rect, 1=ellipse, 2=rounded rect
-    int brickHP[BRICKS_X][BRICKS_Y]; // hit points for each brick
-    Uint32 lastPaddlePressTime[2]; // 0=left, 1=right, for double-tap detection
-    double paddleCollisionCooldown; // cooldown after paddle hit
-    bool justBouncedPaddle; // skip paddle collision for 1 frame
-    bool ballHasClearedPaddle; // only allow paddle collision if ball has cleared paddle
+    SDL_Color brickColors[BRICKS_X][BRICKS_Y] = {};
+    int brickShapes[BRICKS_X][BRICKS_Y] = {}; // 0=rect, 1=ellipse, 2=rounded rect
+    int brickWallShape = 2; // 0=rect, 1=ellipse, 2=rounded rect
+    int brickHP[BRICKS_X][BRICKS_Y] = {}; // hit points for each brick
+    Uint32 lastPaddlePressTime[2] = {}; // 0=left, 1=right, for double-tap detection
+    bool paddleKeyHeld[2] = {}; // 0=left, 1=right, as of last frame
+    Animator anims; // brick effects and cooldowns, on the game clock
+    AnimHandle brickTint[BRICKS_X][BRICKS_Y] = {};  // damage colour fade
+    AnimHandle brickMorph[BRICKS_X][BRICKS_Y] = {}; // outline blend towards brickMorphShape
+    int brickMorphShape[BRICKS_X][BRICKS_Y] = {}; // shape a running morph ends in
+    AnimHandle brickScale[BRICKS_X][BRICKS_Y] = {}; // shrink-out after destruction
+    AnimHandle paddleCooldown = 0; // cooldown after paddle hit
+    AnimHandle paddleBoost = 0; // double-tap speed burst
+    int paddleBoostDir = 0; // -1=left, 1=right
+    bool justBouncedPaddle = false; // skip paddle collision for 1 frame
+    bool ballHasClearedPaddle = false; // only allow paddle collision if ball has cleared paddle
 };
 #endif // __GAME_H
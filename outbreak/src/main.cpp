@@ -1,12 +1,53 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #include "Game.h"
 
-int main(void)
+/*
+  OutBreak [--capture PATH] [--frames N] [--fps N] [--seed N]
+           [--background N] [--autoplay]
+
+  --capture renders headless and writes every frame to PATH: a .y4m
+  file, or a printf-style PNG pattern such as "shots/frame%05d.png".
+  Give --seed too for frames that can be diffed between runs.
+*/
+int main(int argc, char **argv)
 {
+    GameOptions opts;
+    unsigned int seed = time(NULL);
+    for (int i = 1; i < argc; ++i) {
+        const char *next = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (!strcmp(argv[i], "--capture") && next) {
+            opts.capturePath = argv[++i];
+        } else if (!strcmp(argv[i], "--frames") && next) {
+            opts.captureFrames = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--fps") && next) {
+            opts.captureFps = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--seed") && next) {
+            seed = strtoul(argv[++i], NULL, 10);
+        } else if (!strcmp(argv[i], "--background") && next) {
+            opts.background = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--autoplay")) {
+            opts.autoPlay = true;
+        } else {
+            printf("unknown option %s\n", argv[i]);
+            return 1;
+        }
+    }
+    // Each captured frame is one game step; above 1/20 s per step the ball
+    // jumps far enough to pass through the paddle and bricks
+    if (opts.captureFps < 20) {
+        printf("--fps must be at least 20\n");
+        return 1;
+    }
+    if (opts.captureFrames < 1) {
+        printf("--frames must be at least 1\n");
+        return 1;
+    }
+
     // seed the prng
-    srand(time(NULL));
-	Game game;
-    return 0;
+    gameSeed(seed);
+	Game game(opts);
+    return game.ok() ? 0 : 1;
 }
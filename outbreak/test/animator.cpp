@@ -0,0 +1,150 @@
+#include "../src/Animation.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+/*
+  Unit checks for the Animator timer wheel: exact expiry across level
+  1/2/3 cascades, cancellation, and stale handles staying inactive.
+  Exits non-zero on the first failing group.
+*/
+static int failures = 0;
+
+#define CHECK(cond, ...) do { \
+    if (!(cond)) { failures++; printf("FAIL %s:%d: ", __FILE__, __LINE__); printf(__VA_ARGS__); printf("\n"); } \
+} while (0)
+
+struct Fired {
+    Uint32 *clock;  // test-side time the wheel was advanced to
+    Uint32 at;      // when the callback ran, 0 = never
+    int count;
+};
+
+static void onFired(void *ctx, int, const float *) {
+    Fired *f = (Fired *)ctx;
+    f->at = *f->clock;
+    f->count++;
+}
+
+// Every timer must fire exactly once, on the millisecond it is due
+static void testExactExpiry() {
+    const Uint32 durations[] = {
+        1, 2, 63, 64, 65, 127, 128,                 // level 0 -> 1
+        4095, 4096, 4097, 5000,                     // level 1 -> 2
+        262143, 262144, 262145, 300000,             // level 2 -> 3
+        1000000, 16777215,                          // deep in level 3
+    };
+    const int n = sizeof(durations) / sizeof(durations[0]);
+    Animator anims;
+    Uint32 clock = 0;
+    // Start off a slot boundary so cascades happen mid-schedule
+    clock = 37;
+    anims.advance(clock);
+    std::vector<Fired> fired(n);
+    std::vector<Uint32> due(n);
+    for (int k = 0; k < n; ++k) {
+        fired[k] = { &clock, 0, 0 };
+        due[k] = clock + durations[k];
+        anims.timer(durations[k], onFired, &fired[k]);
+    }
+    while (anims.live() > 0 && clock < 37 + 16777215 + 1) {
+        clock++;
+        anims.advance(clock);
+    }
+    for (int k = 0; k < n; ++k) {
+        CHECK(fired[k].count == 1, "timer of %u ms fired %d times", durations[k], fired[k].count);
+        CHECK(fired[k].at == due[k], "timer of %u ms fired at %u, due %u", durations[k], fired[k].at, due[k]);
+    }
+}
+
+// Randomised schedule with cancels against a plain list of due times
+static void testRandomSchedule() {
+    Animator anims;
+    Uint32 clock = 0;
+    const int n = 20000;
+    std::vector<Fired> fired(n);
+    std::vector<Uint32> due(n);
+    std::vector<AnimHandle> handles(n);
+    std::vector<bool> cancelled(n, false);
+    srand(1);
+    int started = 0;
+    while (started < n || anims.live() > 0) {
+        clock++;
+        anims.advance(clock);
+        for (int k = 0; k < 3 && started < n; ++k, ++started) {
+            Uint32 d = 1 + ((rand() % 4 == 0) ? rand() % 400000 : rand() % 2000);
+            fired[started] = { &clock, 0, 0 };
+            due[started] = clock + d;
+            handles[started] = anims.timer(d, onFired, &fired[started]);
+        }
+        if (started > 0 && rand() % 7 == 0) {
+            int victim = rand() % started;
+            if (anims.active(handles[victim])) {
+                anims.cancel(handles[victim]);
+                cancelled[victim] = true;
+                CHECK(!anims.active(handles[victim]), "cancelled timer %d still active", victim);
+            }
+        }
+    }
+    for (int k = 0; k < n; ++k) {
+        if (cancelled[k]) {
+            CHECK(fired[k].count == 0, "cancelled timer %d fired", k);
+        } else {
+            CHECK(fired[k].count == 1 && fired[k].at == due[k],
+                  "timer %d fired %d times at %u, due %u", k, fired[k].count, fired[k].at, due[k]);
+        }
+    }
+}
+
+// A finished or cancelled handle must never alias a later record in its slot
+static void testStaleHandles() {
+    Animator anims;
+    Uint32 clock = 0;
+    Fired f = { &clock, 0, 0 };
+    AnimHandle first = anims.timer(5, onFired, &f);
+    CHECK(anims.active(first), "new timer inactive");
+    clock = 5;
+    anims.advance(clock);
+    CHECK(f.count == 1, "timer did not fire");
+    CHECK(!anims.active(first), "expired handle still active");
+
+    // Reuse the same slot well past the old 12-bit generation wrap
+    AnimHandle cancelledOne = anims.timer(100);
+    anims.cancel(cancelledOne);
+    for (int k = 0; k < 100000; ++k) {
+        AnimHandle h = anims.timer(100);
+        CHECK(!anims.active(first) && !anims.active(cancelledOne), "stale handle aliased after %d reuses", k);
+        float v[4];
+        CHECK(!anims.sample(first, v), "stale handle sampled after %d reuses", k);
+        anims.cancel(h);
+        if (failures) return;
+    }
+    CHECK(anims.live() == 0, "%d records leaked", anims.live());
+}
+
+// Tweens are smoothstepped between from and to
+static void testSample() {
+    Animator anims;
+    float from[4] = { 0, 10, 100, 255 }, to[4] = { 1, 20, 0, 255 }, v[4];
+    AnimHandle h = anims.tween(100, from, to);
+    CHECK(anims.sample(h, v) && v[0] == 0 && v[1] == 10, "tween does not start at from");
+    anims.advance(50);
+    CHECK(anims.sample(h, v) && v[0] == 0.5f && v[1] == 15 && v[2] == 50, "tween midpoint is %g %g %g", v[0], v[1], v[2]);
+    anims.advance(100);
+    CHECK(!anims.sample(h, v), "finished tween still samples");
+}
+
+int main(void)
+{
+    testExactExpiry();
+    testRandomSchedule();
+    testStaleHandles();
+    testSample();
+    if (failures) {
+        printf("animator: %d failures\n", failures);
+        return 1;
+    }
+    printf("animator: ok\n");
+    return 0;
+}
@@ -0,0 +1,55 @@
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+  framediff A.png B.png [tolerance]
+
+  Compares two captured frames pixel by pixel. Exits 0 if they have the
+  same size and every channel is within tolerance (default 0), 1 if not.
+*/
+static SDL_Surface *loadRGBA(const char *path) {
+    SDL_Surface *img = IMG_Load(path);
+    if (!img) {
+        printf("framediff: could not load %s: %s\n", path, SDL_GetError());
+        return NULL;
+    }
+    SDL_Surface *rgba = SDL_ConvertSurfaceFormat(img, SDL_PIXELFORMAT_RGBA32, 0);
+    SDL_FreeSurface(img);
+    return rgba;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3) {
+        printf("usage: framediff A.png B.png [tolerance]\n");
+        return 2;
+    }
+    int tolerance = (argc > 3) ? atoi(argv[3]) : 0;
+    SDL_Surface *a = loadRGBA(argv[1]);
+    SDL_Surface *b = loadRGBA(argv[2]);
+    if (!a || !b) return 2;
+    if (a->w != b->w || a->h != b->h) {
+        printf("framediff: %s is %dx%d, %s is %dx%d\n", argv[1], a->w, a->h, argv[2], b->w, b->h);
+        return 1;
+    }
+    long differing = 0;
+    for (int y = 0; y < a->h; ++y) {
+        const Uint8 *pa = (const Uint8 *)a->pixels + y * a->pitch;
+        const Uint8 *pb = (const Uint8 *)b->pixels + y * b->pitch;
+        for (int x = 0; x < a->w * 4; x += 4) {
+            for (int c = 0; c < 4; ++c) {
+                if (abs(pa[x + c] - pb[x + c]) > tolerance) { differing++; break; }
+            }
+        }
+    }
+    SDL_FreeSurface(a);
+    SDL_FreeSurface(b);
+    if (differing) {
+        printf("framediff: %s and %s differ in %ld pixels\n", argv[1], argv[2], differing);
+        return 1;
+    }
+    return 0;
+}
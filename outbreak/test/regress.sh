@@ -0,0 +1,52 @@
+#!/bin/sh
+# Pixel-diff regression for renderWorld (every background mode),
+# renderBrickWorld, renderBall and renderPaddle.
+#
+# Captures each background headless with a fixed seed and autoplay, then
+# compares against the frames kept in test/reference.
+#
+#   test/regress.sh            compare (run via `make regress`)
+#   test/regress.sh --update   re-record references from a known-good build
+
+cd "$(dirname "$0")/.." || exit 1
+ROOT=$(pwd)
+OUT=$ROOT/target/regress
+REF=$ROOT/test/reference
+SEED=1234
+FRAMES=120
+KEEP="00000 00030 00060 00090 00119" # reference frames kept per mode
+TOLERANCE=${TOLERANCE:-0}
+
+status=0
+for bg in 0 1 2 3; do
+    rm -rf "$OUT/bg$bg"
+    mkdir -p "$OUT/bg$bg"
+    # The game loads its artwork from the working directory
+    if ! (cd "$ROOT/target" && ./OutBreak --capture "$OUT/bg$bg/f%05d.png" --frames $FRAMES \
+            --seed $SEED --background $bg --autoplay > "$OUT/bg$bg.log"); then
+        echo "FAIL bg$bg: capture failed, see $OUT/bg$bg.log"
+        status=1
+        continue
+    fi
+    if [ "$1" = "--update" ]; then
+        mkdir -p "$REF/bg$bg"
+        for f in $KEEP; do cp "$OUT/bg$bg/f$f.png" "$REF/bg$bg/"; done
+        echo "updated bg$bg"
+        continue
+    fi
+    if [ ! -d "$REF/bg$bg" ]; then
+        # References are only valid for the build that recorded them, so a
+        # fresh checkout has none; report it rather than failing
+        echo "SKIP bg$bg: no reference frames, record them with \`make regress-update\`"
+        continue
+    fi
+    ok=1
+    for ref in "$REF/bg$bg"/*.png; do
+        if ! "$ROOT/target/framediff" "$ref" "$OUT/bg$bg/$(basename "$ref")" $TOLERANCE; then
+            ok=0
+            status=1
+        fi
+    done
+    [ $ok -eq 1 ] && echo "ok bg$bg"
+done
+exit $status